@@ -15,7 +15,8 @@ CONFIG   -= app_bundle
 TEMPLATE = app
 
 
-SOURCES += tst_mappingtest.cpp
+SOURCES += tst_mappingtest.cpp \
+    ../../common/testfixtures.cpp
 DEFINES += SRCDIR=\\\"$$PWD/\\\"
 
 debug {
@@ -86,3 +87,8 @@ LIBS += -L$$quote(X:\swipl\lib) -llibswipl
 
 RESOURCES += \
     protocols.qrc
+
+HEADERS += \
+    ../../common/testfixtures.h
+
+INCLUDEPATH += ../../common
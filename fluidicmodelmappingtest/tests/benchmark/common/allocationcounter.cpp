@@ -0,0 +1,72 @@
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<long long> allocations(0);
+std::atomic<long long> allocatedBytes(0);
+
+void* countedAlloc(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+}
+
+long long AllocationCounter::getAllocations() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+long long AllocationCounter::getAllocatedBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    void* ptr = countedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr = countedAlloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
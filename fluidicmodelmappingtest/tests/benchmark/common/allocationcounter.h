@@ -0,0 +1,21 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+/*
+ * Counters fed by the global operator new replacement in allocationcounter.cpp.
+ *
+ * Only operator new is hooked, memory taken with malloc is never counted. That leaves out
+ * SWI-Prolog, where most of the mapping time goes, and the buffers of QByteArray, QString
+ * and the QJson classes.
+ * On Windows every dll keeps its own operator new, so only the allocations made
+ * from code compiled into the benchmark (including templates instantiated from the
+ * libraries headers) are counted there.
+ */
+class AllocationCounter
+{
+public:
+    static long long getAllocations();
+    static long long getAllocatedBytes();
+};
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,175 @@
+#include "benchmarkrecorder.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <sstream>
+
+#ifdef Q_OS_WIN
+//keeps windows.h from defining the min and max macros used below through std::min, std::max and numeric_limits
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "allocationcounter.h"
+
+StageMeasure::StageMeasure(const std::string & stage, const std::string & fixture, const std::string & machine) :
+    stage(stage), fixture(fixture), machine(machine)
+{
+    iterations = 0;
+    failedIterations = 0;
+    failedTotalNs = 0;
+    totalNs = 0;
+    minNs = std::numeric_limits<qint64>::max();
+    maxNs = 0;
+    allocations = 0;
+    allocatedBytes = 0;
+    processPeakRssBytes = 0;
+
+    allocationsAtStart = 0;
+    bytesAtStart = 0;
+}
+
+StageMeasure::~StageMeasure() {
+
+}
+
+void StageMeasure::start() {
+    allocationsAtStart = AllocationCounter::getAllocations();
+    bytesAtStart = AllocationCounter::getAllocatedBytes();
+    timer.start();
+}
+
+void StageMeasure::stop(bool succeeded) {
+    qint64 elapsed = timer.nsecsElapsed();
+
+    if (!succeeded) {
+        failedIterations++;
+        failedTotalNs += elapsed;
+        return;
+    }
+
+    allocations += AllocationCounter::getAllocations() - allocationsAtStart;
+    allocatedBytes += AllocationCounter::getAllocatedBytes() - bytesAtStart;
+
+    totalNs += elapsed;
+    minNs = std::min(minNs, elapsed);
+    maxNs = std::max(maxNs, elapsed);
+    iterations++;
+
+    processPeakRssBytes = BenchmarkRecorder::getProcessPeakRssBytes();
+}
+
+std::string StageMeasure::toString() const {
+    std::stringstream stream;
+    int divisor = std::max(iterations, 1);
+
+    stream << stage << "[" << fixture;
+    if (!machine.empty()) {
+        stream << "," << machine;
+    }
+    stream << "]: ";
+    stream << "mean " << (totalNs / divisor) / 1000 << " us, ";
+    stream << "min " << (iterations > 0 ? minNs / 1000 : 0) << " us, ";
+    stream << "max " << maxNs / 1000 << " us, ";
+    stream << "failed " << failedIterations << ", ";
+    stream << "allocations " << allocations / divisor << ", ";
+    stream << "allocated " << allocatedBytes / divisor << " B, ";
+    stream << "process peak rss " << processPeakRssBytes / 1024 << " KB";
+    return stream.str();
+}
+
+BenchmarkRecorder::BenchmarkRecorder(const std::string & suiteName) :
+    suiteName(suiteName)
+{
+
+}
+
+BenchmarkRecorder::~BenchmarkRecorder() {
+
+}
+
+void BenchmarkRecorder::addMeasure(const StageMeasure & measure) {
+    measures.push_back(measure);
+}
+
+void BenchmarkRecorder::writeJson(const QString & path) const throw(std::runtime_error) {
+    QJsonArray results;
+    for(const StageMeasure & measure: measures) {
+        int divisor = std::max(measure.getIterations(), 1);
+
+        QJsonObject wallTime;
+        wallTime["mean"] = static_cast<double>(measure.getTotalNs() / divisor);
+        wallTime["min"] = static_cast<double>(measure.getIterations() > 0 ? measure.getMinNs() : 0);
+        wallTime["max"] = static_cast<double>(measure.getMaxNs());
+
+        QJsonObject result;
+        result["stage"] = QString::fromStdString(measure.getStage());
+        result["fixture"] = QString::fromStdString(measure.getFixture());
+        result["machine"] = QString::fromStdString(measure.getMachine());
+        result["iterations"] = measure.getIterations();
+        result["wallTimeNs"] = wallTime;
+        result["failedIterations"] = measure.getFailedIterations();
+        result["failedMeanWallTimeNs"] =
+                static_cast<double>(measure.getFailedIterations() > 0 ? measure.getFailedTotalNs() / measure.getFailedIterations() : 0);
+        result["allocationScope"] = allocationScope();
+        result["allocationsPerIteration"] = static_cast<double>(measure.getAllocations() / divisor);
+        result["allocatedBytesPerIteration"] = static_cast<double>(measure.getAllocatedBytes() / divisor);
+        result["processPeakRssBytes"] = static_cast<double>(measure.getProcessPeakRssBytes());
+        results.append(result);
+    }
+
+    QJsonObject root;
+    root["suite"] = QString::fromStdString(suiteName);
+    root["allocationScope"] = allocationScope();
+    root["processPeakRssScope"] = "cumulative";
+    root["results"] = results;
+
+    QFile outFile(path);
+    if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        throw(std::runtime_error("imposible to open " + path.toStdString()));
+    }
+
+    QByteArray json = QJsonDocument(root).toJson();
+    if (outFile.write(json) != json.size() || !outFile.flush()) {
+        throw(std::runtime_error("imposible to write " + path.toStdString()));
+    }
+}
+
+long long BenchmarkRecorder::getProcessPeakRssBytes() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long long>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+        return static_cast<long long>(usage.ru_maxrss);
+#else
+        return static_cast<long long>(usage.ru_maxrss) * 1024;
+#endif
+    }
+    return 0;
+#endif
+}
+
+const char* BenchmarkRecorder::allocationScope() {
+    //only operator new is hooked, malloc (swipl, Qt containers) is never counted
+#ifdef Q_OS_WIN
+    //every dll has its own operator new, only the benchmark executable allocations are counted
+    return "operator-new/benchmark-only";
+#else
+    return "operator-new";
+#endif
+}
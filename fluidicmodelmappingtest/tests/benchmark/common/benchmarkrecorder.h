@@ -0,0 +1,106 @@
+#ifndef BENCHMARKRECORDER_H
+#define BENCHMARKRECORDER_H
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Wall time, allocations and memory of one benchmark stage.
+ *
+ * processPeakRss is the high-water mark of the whole process when the stage last stopped, it is
+ * cumulative and includes every stage run before.
+ * Allocations are the operator new calls of the benchmark executable, malloc is not counted and on
+ * Windows neither are the allocations made inside the libraries dlls, see BenchmarkRecorder::allocationScope.
+ */
+class StageMeasure
+{
+public:
+    StageMeasure(const std::string & stage, const std::string & fixture, const std::string & machine);
+    virtual ~StageMeasure();
+
+    void start();
+    void stop(bool succeeded = true);
+
+    std::string toString() const;
+
+    inline const std::string & getStage() const {
+        return stage;
+    }
+    inline const std::string & getFixture() const {
+        return fixture;
+    }
+    inline const std::string & getMachine() const {
+        return machine;
+    }
+    inline int getIterations() const {
+        return iterations;
+    }
+    inline int getFailedIterations() const {
+        return failedIterations;
+    }
+    inline qint64 getFailedTotalNs() const {
+        return failedTotalNs;
+    }
+    inline qint64 getTotalNs() const {
+        return totalNs;
+    }
+    inline qint64 getMinNs() const {
+        return minNs;
+    }
+    inline qint64 getMaxNs() const {
+        return maxNs;
+    }
+    inline long long getAllocations() const {
+        return allocations;
+    }
+    inline long long getAllocatedBytes() const {
+        return allocatedBytes;
+    }
+    inline long long getProcessPeakRssBytes() const {
+        return processPeakRssBytes;
+    }
+
+protected:
+    std::string stage;
+    std::string fixture;
+    std::string machine;
+
+    //failed runs are kept apart so they never skew the successful ones
+    int iterations;
+    int failedIterations;
+    qint64 failedTotalNs;
+    qint64 totalNs;
+    qint64 minNs;
+    qint64 maxNs;
+    long long allocations;
+    long long allocatedBytes;
+    long long processPeakRssBytes;
+
+    QElapsedTimer timer;
+    long long allocationsAtStart;
+    long long bytesAtStart;
+};
+
+class BenchmarkRecorder
+{
+public:
+    BenchmarkRecorder(const std::string & suiteName);
+    virtual ~BenchmarkRecorder();
+
+    void addMeasure(const StageMeasure & measure);
+    void writeJson(const QString & path) const throw(std::runtime_error);
+
+    static long long getProcessPeakRssBytes();
+    static const char* allocationScope();
+
+protected:
+    std::string suiteName;
+    std::vector<StageMeasure> measures;
+};
+
+#endif // BENCHMARKRECORDER_H
@@ -0,0 +1,97 @@
+#-------------------------------------------------
+#
+# Mapping pipeline benchmark
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_mappingpipelinebenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += tst_mappingpipelinebenchmark.cpp \
+    ../common/benchmarkrecorder.cpp \
+    ../common/allocationcounter.cpp \
+    ../../common/testfixtures.cpp
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
+
+debug {
+    INCLUDEPATH += X:\fluidicMachineModel\dll_debug\include
+    LIBS += -L$$quote(X:\fluidicMachineModel\dll_debug\bin) -lFluidicMachineModel
+
+    INCLUDEPATH += X:\commomModel\dll_debug\include
+    LIBS += -L$$quote(X:\commomModel\dll_debug\bin) -lcommonModel
+
+    INCLUDEPATH += X:\protocolGraph\dll_debug\include
+    LIBS += -L$$quote(X:\protocolGraph\dll_debug\bin) -lprotocolGraph
+
+    INCLUDEPATH += X:\fluidicModelMapping\dll_debug\include
+    LIBS += -L$$quote(X:\fluidicModelMapping\dll_debug\bin) -lFluidicModelMapping
+
+    INCLUDEPATH += X:\constraintsEngine\dll_debug\include
+    LIBS += -L$$quote(X:\constraintsEngine\dll_debug\bin) -lconstraintsEngineLibrary
+
+    INCLUDEPATH += X:\utils\dll_debug\include
+    LIBS += -L$$quote(X:\utils\dll_debug\bin) -lutils
+
+    INCLUDEPATH += X:\bioblocksTranslation\dll_debug\include
+    LIBS += -L$$quote(X:\bioblocksTranslation\dll_debug\bin) -lbioblocksTranslation
+
+    INCLUDEPATH += X:\bioblocksExecution\dll_debug\include
+    LIBS += -L$$quote(X:\bioblocksExecution\dll_debug\bin) -lbioblocksExecution
+}
+
+!debug {
+    INCLUDEPATH += X:\fluidicMachineModel\dll_release\include
+    LIBS += -L$$quote(X:\fluidicMachineModel\dll_release\bin) -lFluidicMachineModel
+
+    INCLUDEPATH += X:\commomModel\dll_release\include
+    LIBS += -L$$quote(X:\commomModel\dll_release\bin) -lcommonModel
+
+    INCLUDEPATH += X:\protocolGraph\dll_release\include
+    LIBS += -L$$quote(X:\protocolGraph\dll_release\bin) -lprotocolGraph
+
+    INCLUDEPATH += X:\fluidicModelMapping\dll_release\include
+    LIBS += -L$$quote(X:\fluidicModelMapping\dll_release\bin) -lFluidicModelMapping
+
+    INCLUDEPATH += X:\constraintsEngine\dll_release\include
+    LIBS += -L$$quote(X:\constraintsEngine\dll_release\bin) -lconstraintsEngineLibrary
+
+    INCLUDEPATH += X:\utils\dll_release\include
+    LIBS += -L$$quote(X:\utils\dll_release\bin) -lutils
+
+    INCLUDEPATH += X:\bioblocksTranslation\dll_release\include
+    LIBS += -L$$quote(X:\bioblocksTranslation\dll_release\bin) -lbioblocksTranslation
+
+    INCLUDEPATH += X:\bioblocksExecution\dll_release\include
+    LIBS += -L$$quote(X:\bioblocksExecution\dll_release\bin) -lbioblocksExecution
+}
+
+INCLUDEPATH += X:\libraries\json-2.1.1\src
+INCLUDEPATH += X:\libraries\boost_1_63_0
+INCLUDEPATH += X:\libraries\cereal-1.2.2\include
+
+INCLUDEPATH += X:\swipl\include
+LIBS += -L$$quote(X:\swipl\bin) -llibswipl
+LIBS += -L$$quote(X:\swipl\lib) -llibswipl
+
+RESOURCES += \
+    ../../auto/mapping/protocols.qrc
+
+HEADERS += \
+    ../../common/testfixtures.h \
+    ../common/benchmarkrecorder.h \
+    ../common/allocationcounter.h
+
+win32 {
+    LIBS += -lpsapi
+}
+
+INCLUDEPATH += ../common
+INCLUDEPATH += ../../common
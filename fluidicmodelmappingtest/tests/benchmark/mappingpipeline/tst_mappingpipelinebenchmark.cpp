@@ -0,0 +1,358 @@
+#include <QString>
+#include <QtTest>
+#include <QTemporaryFile>
+#include <QFile>
+
+#include <algorithm>
+#include <map>
+
+#include <bioblocksExecution/bioblocksSimulation/bioblocksrunningsimulator.h>
+
+#include <bioblocksTranslation/bioblockstranslator.h>
+#include <bioblocksTranslation/logicblocksmanager.h>
+
+#include <constraintengine/prologtranslationstack.h>
+
+#include <fluidicmachinemodel/fluidicmachinemodel.h>
+#include <fluidicmachinemodel/machinegraph.h>
+
+#include <fluidicmodelmapping/fluidicmodelmapping.h>
+#include <fluidicmodelmapping/heuristic/containercharacteristics.h>
+#include <fluidicmodelmapping/heuristic/topologyheuristic.h>
+#include <fluidicmodelmapping/protocolAnalysis/analysisexecutor.h>
+#include <fluidicmodelmapping/searchalgorithms/astarsearch.h>
+
+#include <utils/machineflowstringadapter.h>
+
+#include "benchmarkrecorder.h"
+#include "testfixtures.h"
+
+/*
+ * Times every stage of the mapping pipeline on the mapping test fixtures.
+ *
+ * BENCHMARK_ITERATIONS: times each stage is run per row, default 5.
+ * BENCHMARK_OUTPUT: json file where the results are written, default mappingpipeline_benchmark.json.
+ */
+class MappingPipelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    MappingPipelineBenchmark();
+
+private:
+    int iterations;
+    BenchmarkRecorder recorder;
+    std::map<QString, std::shared_ptr<QTemporaryFile>> fixtureFiles;
+
+    std::shared_ptr<MachineGraph> makeMachine(const QString & machineName) throw(std::invalid_argument);
+
+    std::shared_ptr<ProtocolGraph> translateFixture(const QString & fixture,
+                                                    double timeSliceSeconds,
+                                                    std::shared_ptr<LogicBlocksManager> logicBlocks);
+
+    void analyseFixture(const QString & fixture,
+                        double timeSliceSeconds,
+                        std::vector<ContainerCharacteristics> & containerCharacteristics,
+                        std::vector<MachineFlowStringAdapter::FlowsVector> & flowsintime);
+
+    void addFixtureRows();
+    void addFixtureMachineRows();
+
+    void copyResourceFile(const QString & resourcePath, QTemporaryFile* tempFile) throw(std::invalid_argument, std::runtime_error);
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void translateFile_data();
+    void translateFile();
+
+    void analysisExecutor_data();
+    void analysisExecutor();
+
+    void topologyHeuristic_data();
+    void topologyHeuristic();
+
+    void aStarSearch_data();
+    void aStarSearch();
+
+    void findRelation_data();
+    void findRelation();
+};
+
+MappingPipelineBenchmark::MappingPipelineBenchmark() :
+    recorder("mappingpipeline")
+{
+    iterations = 5;
+}
+
+void MappingPipelineBenchmark::initTestCase() {
+    bool ok = false;
+    int envIterations = qgetenv("BENCHMARK_ITERATIONS").toInt(&ok);
+    if (ok && envIterations > 0) {
+        iterations = envIterations;
+    }
+
+    //created before anything can fail, cleanupTestCase always destroys it
+    PrologExecutor::createEngine(std::string(QTest::currentAppName()));
+
+    std::vector<QString> fixtures = {"trubidostat", "switchingProtocol"};
+    for(const QString & fixture: fixtures) {
+        std::shared_ptr<QTemporaryFile> tempFile = std::make_shared<QTemporaryFile>();
+        QVERIFY2(tempFile->open(), "imposible to create temporary file");
+        try {
+            copyResourceFile(":/protocol/protocolos/" + fixture + ".json", tempFile.get());
+        } catch (std::exception & e) {
+            QFAIL(e.what());
+        }
+        fixtureFiles.insert(std::make_pair(fixture, tempFile));
+    }
+}
+
+void MappingPipelineBenchmark::cleanupTestCase() {
+    PrologExecutor::destoryEngine();
+
+    QString outputPath = "mappingpipeline_benchmark.json";
+    QByteArray envOutput = qgetenv("BENCHMARK_OUTPUT");
+    if (!envOutput.isEmpty()) {
+        outputPath = QString::fromLocal8Bit(envOutput);
+    }
+
+    try {
+        recorder.writeJson(outputPath);
+        qDebug() << "benchmark results written to" << outputPath;
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::translateFile_data() {
+    addFixtureRows();
+}
+
+void MappingPipelineBenchmark::translateFile() {
+    QFETCH(QString, fixture);
+    QFETCH(double, timeSliceSeconds);
+
+    try {
+        StageMeasure measure("translateFile", fixture.toStdString(), "");
+        for(int i = 0; i < iterations; i++) {
+            std::shared_ptr<LogicBlocksManager> logicBlocks = std::make_shared<LogicBlocksManager>();
+            BioBlocksTranslator translator(timeSliceSeconds * units::s, fixtureFiles.at(fixture)->fileName().toStdString());
+
+            measure.start();
+            std::shared_ptr<ProtocolGraph> protocol = translator.translateFile(logicBlocks);
+            measure.stop();
+
+            QVERIFY2(protocol, "protocol not translated");
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::analysisExecutor_data() {
+    addFixtureRows();
+}
+
+void MappingPipelineBenchmark::analysisExecutor() {
+    QFETCH(QString, fixture);
+    QFETCH(double, timeSliceSeconds);
+
+    try {
+        StageMeasure measure("analysisExecutor", fixture.toStdString(), "");
+        for(int i = 0; i < iterations; i++) {
+            std::shared_ptr<LogicBlocksManager> logicBlocks = std::make_shared<LogicBlocksManager>();
+            std::shared_ptr<ProtocolGraph> protocol = translateFixture(fixture, timeSliceSeconds, logicBlocks);
+
+            measure.start();
+            std::shared_ptr<BioBlocksRunningSimulator> simulator = std::make_shared<BioBlocksRunningSimulator>(protocol, logicBlocks);
+            AnalysisExecutor executor(simulator, 300 * units::ml/units::hr);
+            measure.stop();
+
+            QVERIFY2(!executor.getFlowsInTime().empty(), "no flows generated");
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::topologyHeuristic_data() {
+    addFixtureMachineRows();
+}
+
+void MappingPipelineBenchmark::topologyHeuristic() {
+    QFETCH(QString, fixture);
+    QFETCH(double, timeSliceSeconds);
+    QFETCH(QString, machine);
+
+    try {
+        std::vector<ContainerCharacteristics> protocolContainersCharacts;
+        std::vector<MachineFlowStringAdapter::FlowsVector> flowsinTime;
+        analyseFixture(fixture, timeSliceSeconds, protocolContainersCharacts, flowsinTime);
+
+        std::shared_ptr<MachineGraph> machineGraph = makeMachine(machine);
+
+        StageMeasure measure("topologyHeuristic", fixture.toStdString(), machine.toStdString());
+        for(int i = 0; i < iterations; i++) {
+            measure.start();
+            std::shared_ptr<HeuristicInterface> topologyH = std::make_shared<TopologyHeuristic>(machineGraph, protocolContainersCharacts);
+            measure.stop();
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::aStarSearch_data() {
+    addFixtureMachineRows();
+}
+
+void MappingPipelineBenchmark::aStarSearch() {
+    QFETCH(QString, fixture);
+    QFETCH(double, timeSliceSeconds);
+    QFETCH(QString, machine);
+
+    try {
+        std::vector<ContainerCharacteristics> protocolContainersCharacts;
+        std::vector<MachineFlowStringAdapter::FlowsVector> flowsinTime;
+        analyseFixture(fixture, timeSliceSeconds, protocolContainersCharacts, flowsinTime);
+
+        StageMeasure measure("aStarSearch", fixture.toStdString(), machine.toStdString());
+        for(int i = 0; i < iterations; i++) {
+            std::shared_ptr<FluidicMachineModel> model = TestFixtures::makeModel(makeMachine(machine));
+            std::shared_ptr<HeuristicInterface> topologyH = std::make_shared<TopologyHeuristic>(model->getMachineGraph(), protocolContainersCharacts);
+            AStarSearch aSearch(model, topologyH, protocolContainersCharacts, flowsinTime);
+
+            std::string errorMsg;
+            measure.start();
+            bool found = aSearch.startSearch(errorMsg);
+            measure.stop();
+
+            QVERIFY2(found, std::string("search fail: " + errorMsg).c_str());
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::findRelation_data() {
+    addFixtureMachineRows();
+}
+
+void MappingPipelineBenchmark::findRelation() {
+    QFETCH(QString, fixture);
+    QFETCH(double, timeSliceSeconds);
+    QFETCH(QString, machine);
+
+    try {
+        StageMeasure measure("findRelation", fixture.toStdString(), machine.toStdString());
+        for(int i = 0; i < iterations; i++) {
+            std::shared_ptr<LogicBlocksManager> logicBlocks = std::make_shared<LogicBlocksManager>();
+            std::shared_ptr<ProtocolGraph> protocol = translateFixture(fixture, timeSliceSeconds, logicBlocks);
+
+            std::shared_ptr<FluidicMachineModel> model = TestFixtures::makeModel(makeMachine(machine));
+            std::shared_ptr<FluidicModelMapping> mapping = std::make_shared<FluidicModelMapping>(model);
+
+            std::shared_ptr<ProtocolSimulatorInterface> simulator =
+                    std::make_shared<BioBlocksRunningSimulator>(protocol, logicBlocks);
+
+            std::string errorMsg;
+            measure.start();
+            bool solution = mapping->findRelation(simulator, errorMsg);
+            measure.stop();
+
+            QVERIFY2(solution, std::string("Impossible to find relation: " + errorMsg).c_str());
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingPipelineBenchmark::addFixtureRows() {
+    QTest::addColumn<QString>("fixture");
+    QTest::addColumn<double>("timeSliceSeconds");
+
+    QTest::newRow("trubidostat") << QString("trubidostat") << 1.0;
+    QTest::newRow("switchingProtocol") << QString("switchingProtocol") << 60.0;
+}
+
+void MappingPipelineBenchmark::addFixtureMachineRows() {
+    QTest::addColumn<QString>("fixture");
+    QTest::addColumn<double>("timeSliceSeconds");
+    QTest::addColumn<QString>("machine");
+
+    QTest::newRow("trubidostat/simple") << QString("trubidostat") << 1.0 << QString("simple");
+    QTest::newRow("trubidostat/multipath") << QString("trubidostat") << 1.0 << QString("multipath");
+    QTest::newRow("switchingProtocol/simple") << QString("switchingProtocol") << 60.0 << QString("simple");
+    QTest::newRow("switchingProtocol/multipath") << QString("switchingProtocol") << 60.0 << QString("multipath");
+}
+
+std::shared_ptr<ProtocolGraph> MappingPipelineBenchmark::translateFixture(const QString & fixture,
+                                                                          double timeSliceSeconds,
+                                                                          std::shared_ptr<LogicBlocksManager> logicBlocks)
+{
+    BioBlocksTranslator translator(timeSliceSeconds * units::s, fixtureFiles.at(fixture)->fileName().toStdString());
+    return translator.translateFile(logicBlocks);
+}
+
+void MappingPipelineBenchmark::analyseFixture(const QString & fixture,
+                                              double timeSliceSeconds,
+                                              std::vector<ContainerCharacteristics> & containerCharacteristics,
+                                              std::vector<MachineFlowStringAdapter::FlowsVector> & flowsintime)
+{
+    std::shared_ptr<LogicBlocksManager> logicBlocks = std::make_shared<LogicBlocksManager>();
+    std::shared_ptr<ProtocolGraph> protocol = translateFixture(fixture, timeSliceSeconds, logicBlocks);
+
+    std::shared_ptr<BioBlocksRunningSimulator> simulator = std::make_shared<BioBlocksRunningSimulator>(protocol, logicBlocks);
+    AnalysisExecutor executor(simulator, 300 * units::ml/units::hr);
+
+    containerCharacteristics = executor.getVCVector();
+    flowsintime = executor.getFlowsInTime();
+
+    std::sort(containerCharacteristics.begin(), containerCharacteristics.end(), ContainerCharacteristics::ContainerCharacteristicsComparator());
+}
+
+std::shared_ptr<MachineGraph> MappingPipelineBenchmark::makeMachine(const QString & machineName) throw(std::invalid_argument) {
+    if (machineName == "simple") {
+        return TestFixtures::makeMachineGraph();
+    } else if (machineName == "multipath") {
+        return TestFixtures::makeMultipathWashMachineGraph();
+    } else {
+        throw(std::invalid_argument("unknow machine " + machineName.toStdString()));
+    }
+}
+
+void MappingPipelineBenchmark::copyResourceFile(const QString & resourcePath, QTemporaryFile* tempFile) throw(std::invalid_argument, std::runtime_error) {
+    QFile resourceFile(resourcePath);
+    if(!resourceFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw(std::invalid_argument("imposible to open" + resourcePath.toStdString()));
+    }
+
+    QTextStream out(tempFile);
+
+    QTextStream in(&resourceFile);
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        out << line;
+    }
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        throw(std::runtime_error("imposible to write " + resourcePath.toStdString() + " to temporary file"));
+    }
+}
+
+QTEST_APPLESS_MAIN(MappingPipelineBenchmark)
+
+#include "tst_mappingpipelinebenchmark.moc"
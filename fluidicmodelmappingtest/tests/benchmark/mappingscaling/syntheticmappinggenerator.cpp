@@ -0,0 +1,274 @@
+#include "syntheticmappinggenerator.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <commonmodel/functions/pumppluginfunction.h>
+#include <commonmodel/functions/valvepluginroutefunction.h>
+
+SyntheticMappingGenerator::SyntheticMappingGenerator(unsigned int seed, const Parameters & parameters) throw(std::invalid_argument) :
+    seed(seed), parameters(parameters), randomEngine(seed)
+{
+    if (parameters.openContainers < 2 ||
+            parameters.closeContainers < 1 ||
+            parameters.pumps < 1 ||
+            parameters.valves < 2 ||
+            parameters.routes < 1)
+    {
+        throw(std::invalid_argument("at least 2 open containers, 1 close container, 1 pump, 2 valves and 1 route are needed"));
+    }
+}
+
+SyntheticMappingGenerator::~SyntheticMappingGenerator() {
+
+}
+
+std::shared_ptr<MachineGraph> SyntheticMappingGenerator::generateMachine() {
+    randomEngine.seed(seed);
+
+    int numNodes = parameters.openContainers + parameters.closeContainers + parameters.pumps + parameters.valves;
+    pinsCount.assign(numNodes, 0);
+    edges.clear();
+    valvesRoutes.assign(parameters.valves, std::vector<std::pair<int,int>>());
+    plantedRoutes.clear();
+    machineIds.assign(numNodes, -1);
+
+    plantRoutes();
+    addExtraEdges();
+    connectUnusedNodes();
+
+    std::shared_ptr<MachineGraph> mGraph = std::make_shared<MachineGraph>();
+    PluginConfiguration config;
+    std::shared_ptr<PluginAbstractFactory> factory = nullptr;
+
+    std::shared_ptr<Function> pumpf =
+            std::make_shared<PumpPluginFunction>(factory, config, PumpWorkingRange(0 * units::ml/units::hr, 999 * units::ml/units::hr));
+    std::shared_ptr<Function> routef = std::make_shared<ValvePluginRouteFunction>(factory, config);
+
+    for(int i = 0; i < parameters.openContainers; i++) {
+        int node = openContainer(i);
+        machineIds[node] = mGraph->emplaceContainer(pinsCount[node], ContainerNode::open, 100.0);
+    }
+    for(int i = 0; i < parameters.closeContainers; i++) {
+        int node = closeContainer(i);
+        machineIds[node] = mGraph->emplaceContainer(pinsCount[node], ContainerNode::close, 100.0);
+    }
+    for(int i = 0; i < parameters.pumps; i++) {
+        int node = pump(i);
+        machineIds[node] = mGraph->emplacePump(pinsCount[node], PumpNode::bidirectional, pumpf);
+    }
+    for(int i = 0; i < parameters.valves; i++) {
+        int node = valve(i);
+        machineIds[node] = mGraph->emplaceValve(pinsCount[node], makeTruthTable(i), routef);
+    }
+
+    for(const EdgeTuple & edge: edges) {
+        mGraph->connectNodes(machineIds[std::get<0>(edge)],
+                             machineIds[std::get<1>(edge)],
+                             std::get<2>(edge),
+                             std::get<3>(edge));
+    }
+
+    for(std::vector<int> & route: plantedRoutes) {
+        for(int & node: route) {
+            node = machineIds[node];
+        }
+    }
+    return mGraph;
+}
+
+QByteArray SyntheticMappingGenerator::generateProtocol(int flowsPerStep, int stepDurationSeconds) throw(std::invalid_argument) {
+    if (plantedRoutes.empty()) {
+        throw(std::invalid_argument("generateMachine must be called before generateProtocol"));
+    }
+    if (flowsPerStep < 1) {
+        throw(std::invalid_argument("flowsPerStep must be at least 1"));
+    }
+
+    QJsonArray linkedBlocks;
+    for(size_t i = 0; i < plantedRoutes.size(); i++) {
+        int step = static_cast<int>(i) / flowsPerStep;
+
+        QJsonArray containerList;
+        for(int machineId: plantedRoutes[i]) {
+            QJsonObject container;
+            container["block_type"] = "container";
+            container["containerName"] = QString::fromStdString(containerName(machineId));
+            container["type"] = "1";
+            container["destiny"] = "Ambient";
+            container["initialVolume"] = "0";
+            container["initialVolumeUnits"] = "ml";
+            containerList.append(container);
+        }
+
+        QJsonObject source;
+        source["block_type"] = "containerList";
+        source["containerList"] = containerList;
+
+        QJsonObject rate;
+        rate["block_type"] = "math_number";
+        rate["value"] = "300";
+
+        QJsonObject flow;
+        flow["timeOfOperation"] = QString::number(step * stepDurationSeconds);
+        flow["timeOfOperation_units"] = "s";
+        flow["linked"] = "FALSE";
+        flow["duration"] = QString::number(stepDurationSeconds);
+        flow["duration_units"] = "s";
+        flow["block_type"] = "continuous_flow";
+        flow["source"] = source;
+        flow["rate"] = rate;
+        flow["rate_volume_units"] = "ml";
+        flow["rate_time_units"] = "hr";
+
+        QJsonArray chain;
+        chain.append(flow);
+        linkedBlocks.append(chain);
+    }
+
+    QJsonObject protocol;
+    protocol["tittle"] = QString("synthetic_%1").arg(seed);
+    protocol["linkedBlocks"] = linkedBlocks;
+
+    return QJsonDocument(protocol).toJson();
+}
+
+std::string SyntheticMappingGenerator::containerName(int machineId) {
+    return "c" + std::to_string(machineId);
+}
+
+int SyntheticMappingGenerator::randomInt(int min, int max) {
+    //mt19937 output is fixed by the standard, distributions are not, so the value is taken
+    //directly from the engine to generate the same machine with every standard library
+    unsigned int range = static_cast<unsigned int>(max - min) + 1;
+    return min + static_cast<int>(randomEngine() % range);
+}
+
+void SyntheticMappingGenerator::shufflePins(std::vector<int> & pins) {
+    for(int i = static_cast<int>(pins.size()) - 1; i > 0; i--) {
+        std::swap(pins[i], pins[randomInt(0, i)]);
+    }
+}
+
+int SyntheticMappingGenerator::openContainer(int index) const {
+    return index;
+}
+
+int SyntheticMappingGenerator::closeContainer(int index) const {
+    return parameters.openContainers + index;
+}
+
+int SyntheticMappingGenerator::pump(int index) const {
+    return parameters.openContainers + parameters.closeContainers + index;
+}
+
+int SyntheticMappingGenerator::valve(int index) const {
+    return parameters.openContainers + parameters.closeContainers + parameters.pumps + index;
+}
+
+bool SyntheticMappingGenerator::isValve(int node) const {
+    return node >= valve(0);
+}
+
+std::pair<int,int> SyntheticMappingGenerator::addEdge(int source, int target) {
+    int sourcePin = pinsCount[source]++;
+    int targetPin = pinsCount[target]++;
+    edges.push_back(std::make_tuple(source, target, sourcePin, targetPin));
+    return std::make_pair(sourcePin, targetPin);
+}
+
+void SyntheticMappingGenerator::plantRoutes() {
+    for(int i = 0; i < parameters.routes; i++) {
+        int source = openContainer(randomInt(0, parameters.openContainers - 1));
+        int target = source;
+        while (target == source) {
+            target = openContainer(randomInt(0, parameters.openContainers - 1));
+        }
+        int middle = closeContainer(randomInt(0, parameters.closeContainers - 1));
+        int pumpNode = pump(randomInt(0, parameters.pumps - 1));
+        int inValve = randomInt(0, parameters.valves - 1);
+        //a valve position opens only one pair of pins, so the in and out valves must differ
+        int outValve = inValve;
+        while (outValve == inValve) {
+            outValve = randomInt(0, parameters.valves - 1);
+        }
+
+        std::pair<int,int> sourceEdge = addEdge(source, valve(inValve));
+        std::pair<int,int> middleEdge = addEdge(valve(inValve), middle);
+        valvesRoutes[inValve].push_back(std::make_pair(sourceEdge.second, middleEdge.first));
+
+        addEdge(middle, pumpNode);
+
+        std::pair<int,int> pumpEdge = addEdge(pumpNode, valve(outValve));
+        std::pair<int,int> targetEdge = addEdge(valve(outValve), target);
+        valvesRoutes[outValve].push_back(std::make_pair(pumpEdge.second, targetEdge.first));
+
+        plantedRoutes.push_back(std::vector<int>{source, middle, target});
+    }
+}
+
+void SyntheticMappingGenerator::addExtraEdges() {
+    int numNodes = static_cast<int>(pinsCount.size());
+    int extraEdges = static_cast<int>(parameters.connectivity * numNodes + 0.5);
+
+    for(int i = 0; i < extraEdges; i++) {
+        int valveNode = valve(randomInt(0, parameters.valves - 1));
+        int other = valveNode;
+        while (other == valveNode) {
+            other = randomInt(0, numNodes - 1);
+        }
+
+        //extra tubes always end in a valve so they can be closed
+        if (randomInt(0, 1) == 0) {
+            addEdge(other, valveNode);
+        } else {
+            addEdge(valveNode, other);
+        }
+    }
+}
+
+void SyntheticMappingGenerator::connectUnusedNodes() {
+    int numNodes = static_cast<int>(pinsCount.size());
+    for(int node = 0; node < numNodes; node++) {
+        if (isValve(node)) {
+            while (pinsCount[node] < 2) {
+                addEdge(node, openContainer(randomInt(0, parameters.openContainers - 1)));
+            }
+        } else if (pinsCount[node] == 0) {
+            addEdge(valve(randomInt(0, parameters.valves - 1)), node);
+        }
+    }
+}
+
+ValveNode::TruthTable SyntheticMappingGenerator::makeTruthTable(int valveIndex) {
+    ValveNode::TruthTable table;
+    std::vector<std::unordered_set<int>> empty;
+    table.insert(std::make_pair(0, empty));
+
+    int position = 1;
+    for(const std::pair<int,int> & route: valvesRoutes[valveIndex]) {
+        std::vector<std::unordered_set<int>> connected = {{route.first, route.second}};
+        table.insert(std::make_pair(position, connected));
+        position++;
+    }
+
+    int numPins = pinsCount[valve(valveIndex)];
+    std::vector<int> pins(numPins);
+    for(int i = 0; i < numPins; i++) {
+        pins[i] = i;
+    }
+
+    for(int i = 0; i < parameters.extraValvePositions; i++) {
+        shufflePins(pins);
+        int groupSize = randomInt(2, std::min(3, numPins));
+
+        std::vector<std::unordered_set<int>> connected = {std::unordered_set<int>(pins.begin(), pins.begin() + groupSize)};
+        table.insert(std::make_pair(position, connected));
+        position++;
+    }
+    return table;
+}
@@ -0,0 +1,83 @@
+#ifndef SYNTHETICMAPPINGGENERATOR_H
+#define SYNTHETICMAPPINGGENERATOR_H
+
+#include <QByteArray>
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fluidicmachinemodel/machinegraph.h>
+
+/*
+ * Seeded generator of MachineGraph instances and of BioBlocks json protocols that can be
+ * mapped onto them.
+ *
+ * Every route is planted as: open container -> valve -> close container -> pump -> other valve -> open container,
+ * the valves get one position per planted route plus some random positions, and extra tubes
+ * are added between random components and valves depending on the connectivity.
+ * The protocol contains one continuous flow per planted route. With one flow per step a mapping
+ * always exists; parallel flows may compete for the same pump or valve.
+ * The same seed generates the same machine and protocol with any standard library.
+ */
+class SyntheticMappingGenerator
+{
+public:
+    typedef struct Parameters_ {
+        int openContainers;
+        int closeContainers;
+        int pumps;
+        int valves;
+        int routes;
+        // extra tubes per machine component
+        double connectivity;
+        // random valve positions added on top of the ones needed by the routes
+        int extraValvePositions;
+    } Parameters;
+
+    SyntheticMappingGenerator(unsigned int seed, const Parameters & parameters) throw(std::invalid_argument);
+    virtual ~SyntheticMappingGenerator();
+
+    std::shared_ptr<MachineGraph> generateMachine();
+    QByteArray generateProtocol(int flowsPerStep, int stepDurationSeconds) throw(std::invalid_argument);
+
+    inline const std::vector<std::vector<int>> & getPlantedRoutes() const {
+        return plantedRoutes;
+    }
+
+    static std::string containerName(int machineId);
+
+protected:
+    typedef std::tuple<int,int,int,int> EdgeTuple;
+
+    unsigned int seed;
+    Parameters parameters;
+    std::mt19937 randomEngine;
+
+    std::vector<int> pinsCount;
+    std::vector<EdgeTuple> edges;
+    std::vector<std::vector<std::pair<int,int>>> valvesRoutes;
+    std::vector<std::vector<int>> plantedRoutes;
+    std::vector<int> machineIds;
+
+    int randomInt(int min, int max);
+    void shufflePins(std::vector<int> & pins);
+
+    int openContainer(int index) const;
+    int closeContainer(int index) const;
+    int pump(int index) const;
+    int valve(int index) const;
+    bool isValve(int node) const;
+
+    std::pair<int,int> addEdge(int source, int target);
+    void plantRoutes();
+    void addExtraEdges();
+    void connectUnusedNodes();
+
+    ValveNode::TruthTable makeTruthTable(int valveIndex);
+};
+
+#endif // SYNTHETICMAPPINGGENERATOR_H
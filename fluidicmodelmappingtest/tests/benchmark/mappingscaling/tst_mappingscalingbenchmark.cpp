@@ -0,0 +1,169 @@
+#include <QString>
+#include <QtTest>
+#include <QTemporaryFile>
+
+#include <sstream>
+
+#include <bioblocksExecution/bioblocksSimulation/bioblocksrunningsimulator.h>
+
+#include <bioblocksTranslation/bioblockstranslator.h>
+#include <bioblocksTranslation/logicblocksmanager.h>
+
+#include <constraintengine/prologtranslationstack.h>
+
+#include <fluidicmachinemodel/fluidicmachinemodel.h>
+#include <fluidicmachinemodel/machinegraph.h>
+
+#include <fluidicmodelmapping/fluidicmodelmapping.h>
+
+#include "benchmarkrecorder.h"
+#include "syntheticmappinggenerator.h"
+#include "testfixtures.h"
+
+/*
+ * Measures how findRelation scales on synthetic machines and protocols.
+ *
+ * BENCHMARK_ITERATIONS: times each row is mapped, default 3.
+ * BENCHMARK_OUTPUT: json file where the results are written, default mappingscaling_benchmark.json.
+ */
+class MappingScalingBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    MappingScalingBenchmark();
+
+private:
+    int iterations;
+    BenchmarkRecorder recorder;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void findRelation_data();
+    void findRelation();
+};
+
+MappingScalingBenchmark::MappingScalingBenchmark() :
+    recorder("mappingscaling")
+{
+    iterations = 3;
+}
+
+void MappingScalingBenchmark::initTestCase() {
+    bool ok = false;
+    int envIterations = qgetenv("BENCHMARK_ITERATIONS").toInt(&ok);
+    if (ok && envIterations > 0) {
+        iterations = envIterations;
+    }
+
+    PrologExecutor::createEngine(std::string(QTest::currentAppName()));
+}
+
+void MappingScalingBenchmark::cleanupTestCase() {
+    PrologExecutor::destoryEngine();
+
+    QString outputPath = "mappingscaling_benchmark.json";
+    QByteArray envOutput = qgetenv("BENCHMARK_OUTPUT");
+    if (!envOutput.isEmpty()) {
+        outputPath = QString::fromLocal8Bit(envOutput);
+    }
+
+    try {
+        recorder.writeJson(outputPath);
+        qDebug() << "benchmark results written to" << outputPath;
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+void MappingScalingBenchmark::findRelation_data() {
+    QTest::addColumn<uint>("seed");
+    QTest::addColumn<int>("openContainers");
+    QTest::addColumn<int>("closeContainers");
+    QTest::addColumn<int>("pumps");
+    QTest::addColumn<int>("valves");
+    QTest::addColumn<int>("routes");
+    QTest::addColumn<double>("connectivity");
+    QTest::addColumn<int>("extraValvePositions");
+    QTest::addColumn<int>("flowsPerStep");
+
+    QTest::newRow("small") << 1u << 4 << 2 << 2 << 4 << 3 << 0.2 << 1 << 1;
+    QTest::newRow("small/parallel") << 1u << 4 << 2 << 2 << 4 << 3 << 0.2 << 1 << 3;
+    QTest::newRow("medium") << 2u << 10 << 4 << 3 << 10 << 6 << 0.3 << 2 << 1;
+    QTest::newRow("medium/dense") << 2u << 10 << 4 << 3 << 10 << 6 << 1.0 << 2 << 1;
+    QTest::newRow("large") << 3u << 24 << 8 << 6 << 24 << 10 << 0.3 << 2 << 1;
+    QTest::newRow("large/parallel") << 3u << 24 << 8 << 6 << 24 << 10 << 0.3 << 2 << 2;
+    QTest::newRow("xlarge") << 4u << 66 << 22 << 14 << 68 << 20 << 0.3 << 2 << 1;
+    QTest::newRow("xlarge/parallel") << 4u << 66 << 22 << 14 << 68 << 20 << 0.3 << 2 << 2;
+}
+
+void MappingScalingBenchmark::findRelation() {
+    QFETCH(uint, seed);
+    QFETCH(int, openContainers);
+    QFETCH(int, closeContainers);
+    QFETCH(int, pumps);
+    QFETCH(int, valves);
+    QFETCH(int, routes);
+    QFETCH(double, connectivity);
+    QFETCH(int, extraValvePositions);
+    QFETCH(int, flowsPerStep);
+
+    try {
+        SyntheticMappingGenerator::Parameters parameters;
+        parameters.openContainers = openContainers;
+        parameters.closeContainers = closeContainers;
+        parameters.pumps = pumps;
+        parameters.valves = valves;
+        parameters.routes = routes;
+        parameters.connectivity = connectivity;
+        parameters.extraValvePositions = extraValvePositions;
+
+        SyntheticMappingGenerator generator(seed, parameters);
+
+        std::stringstream machineDescription;
+        machineDescription << openContainers << " open," << closeContainers << " close,"
+                           << pumps << " pumps," << valves << " valves";
+
+        StageMeasure measure("findRelation", QTest::currentDataTag(), machineDescription.str());
+        for(int i = 0; i < iterations; i++) {
+            std::shared_ptr<MachineGraph> machine = generator.generateMachine();
+
+            QTemporaryFile protocolFile;
+            QVERIFY2(protocolFile.open(), "imposible to create temporary file");
+            protocolFile.write(generator.generateProtocol(flowsPerStep, 30));
+            protocolFile.flush();
+
+            std::shared_ptr<LogicBlocksManager> logicBlocks = std::make_shared<LogicBlocksManager>();
+            BioBlocksTranslator translator(1*units::s, protocolFile.fileName().toStdString());
+            std::shared_ptr<ProtocolGraph> protocol = translator.translateFile(logicBlocks);
+
+            std::shared_ptr<FluidicMachineModel> model = TestFixtures::makeModel(machine);
+            std::shared_ptr<FluidicModelMapping> mapping = std::make_shared<FluidicModelMapping>(model);
+
+            std::shared_ptr<ProtocolSimulatorInterface> simulator =
+                    std::make_shared<BioBlocksRunningSimulator>(protocol, logicBlocks);
+
+            std::string errorMsg;
+            measure.start();
+            bool solution = mapping->findRelation(simulator, errorMsg);
+            measure.stop(solution);
+
+            //sequential planted routes always have a mapping, parallel ones can compete for the same pump or valve
+            if (flowsPerStep == 1) {
+                QVERIFY2(solution, std::string("Impossible to find relation: " + errorMsg).c_str());
+            } else if (!solution) {
+                qWarning() << "no relation found:" << errorMsg.c_str();
+            }
+        }
+        qDebug() << measure.toString().c_str();
+        recorder.addMeasure(measure);
+    } catch (std::exception & e) {
+        QFAIL(e.what());
+    }
+}
+
+QTEST_APPLESS_MAIN(MappingScalingBenchmark)
+
+#include "tst_mappingscalingbenchmark.moc"
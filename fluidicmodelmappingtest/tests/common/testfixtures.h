@@ -0,0 +1,22 @@
+#ifndef TESTFIXTURES_H
+#define TESTFIXTURES_H
+
+#include <memory>
+
+#include <fluidicmachinemodel/fluidicmachinemodel.h>
+#include <fluidicmachinemodel/machinegraph.h>
+
+/*
+ * Machines and models shared by the mapping tests and the benchmarks, so both always run on the
+ * same fixtures.
+ */
+class TestFixtures
+{
+public:
+    static std::shared_ptr<MachineGraph> makeMachineGraph();
+    static std::shared_ptr<MachineGraph> makeMultipathWashMachineGraph();
+
+    static std::shared_ptr<FluidicMachineModel> makeModel(std::shared_ptr<MachineGraph> machine);
+};
+
+#endif // TESTFIXTURES_H